@@ -17,6 +17,25 @@
 #include <iomanip>
 #include <sstream>
 #include <cctype> 
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <cstring>
+#include <ctime>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <deque>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -51,6 +70,30 @@ int strToNum(string str) {
     return x;
 }
 
+// Lock used for state shared by server workers. On Windows only the
+// single-client stdin/stdout server exists, so it compiles to nothing.
+class Mutex {
+#ifndef _WIN32
+    pthread_mutex_t m;
+public:
+    Mutex() { pthread_mutex_init(&m, NULL); }
+    ~Mutex() { pthread_mutex_destroy(&m); }
+    void lock() { pthread_mutex_lock(&m); }
+    void unlock() { pthread_mutex_unlock(&m); }
+#else
+public:
+    void lock() {}
+    void unlock() {}
+#endif
+};
+
+class ScopedLock {
+    Mutex& m;
+public:
+    ScopedLock(Mutex& m) : m(m) { m.lock(); }
+    ~ScopedLock() { m.unlock(); }
+};
+
 // ==========================================
 // DATA STRUCTURES
 // ==========================================
@@ -68,8 +111,9 @@ struct TreeNode {
     string key; 
     double value;
     TreeNode *left, *right;
+    int height;                     // AVL height, a leaf is 1
 
-    TreeNode(string k, double v) : key(k), value(v), left(NULL), right(NULL) {}
+    TreeNode(string k, double v) : key(k), value(v), left(NULL), right(NULL), height(1) {}
 };
 
 // --- 1. Stack ---
@@ -157,45 +201,122 @@ public:
 // --- 4. Circular Linked List ---
 class CircularLinkedList {
     Node* head;
+    Node* tail;
 public:
-    CircularLinkedList() : head(NULL) {}
+    CircularLinkedList() : head(NULL), tail(NULL) {}
 
     void addLog(string log) {
         Node* newNode = new Node(log);
         if (!head) {
-            head = newNode;
+            head = tail = newNode;
         } else {
-            Node* temp = head;
-            while (temp->next) temp = temp->next;
-            temp->next = newNode;
-            newNode->next = head;
+            tail->next = newNode;
+            tail = newNode;
         }
+        tail->next = head;
     }
 };
 
 // --- 5. Binary Search Tree (BST) ---
+// AVL tree whose inserts copy the search path instead of editing nodes in
+// place; the new root is published atomically. Readers therefore walk a
+// tree that never changes under them and take no lock; only writers
+// serialize. Each reader registers in one of two counters, and the nodes
+// an insert replaced are freed once both counters have drained.
 class BST {
     TreeNode* root;
-    
-    TreeNode* insert(TreeNode* node, string key, double val) {
+    Mutex writeLock;
+    int epoch;                      // new readers count in readers[epoch]
+    int readers[2];
+    vector<TreeNode*> retired;      // nodes replaced by the current insert
+
+    static int height(TreeNode* n) { return n ? n->height : 0; }
+
+    static TreeNode* fix(TreeNode* n) {
+        n->height = 1 + max(height(n->left), height(n->right));
+        return n;
+    }
+
+    // Rotations only touch nodes on the insert path, which are fresh copies
+    static TreeNode* rotateRight(TreeNode* n) {
+        TreeNode* l = n->left;
+        n->left = l->right;
+        l->right = fix(n);
+        return fix(l);
+    }
+
+    static TreeNode* rotateLeft(TreeNode* n) {
+        TreeNode* r = n->right;
+        n->right = r->left;
+        r->left = fix(n);
+        return fix(r);
+    }
+
+    static TreeNode* balance(TreeNode* n) {
+        fix(n);
+        int diff = height(n->left) - height(n->right);
+        if (diff > 1) {
+            if (height(n->left->left) < height(n->left->right)) n->left = rotateLeft(n->left);
+            return rotateRight(n);
+        }
+        if (diff < -1) {
+            if (height(n->right->right) < height(n->right->left)) n->right = rotateRight(n->right);
+            return rotateLeft(n);
+        }
+        return n;
+    }
+
+    TreeNode* insert(TreeNode* node, const string& key, double val) {
         if (!node) return new TreeNode(key, val);
-        if (key < node->key) node->left = insert(node->left, key, val);
-        else if (key > node->key) node->right = insert(node->right, key, val);
+        TreeNode* copy = new TreeNode(*node);
+        retired.push_back(node);
+        if (key < node->key) copy->left = insert(node->left, key, val);
+        else if (key > node->key) copy->right = insert(node->right, key, val);
+        else copy->value = val;     // existing name: the copy carries the new value
+        return balance(copy);
+    }
+
+    TreeNode* search(TreeNode* node, const string& key) {
+        while (node && node->key != key) node = (key < node->key) ? node->left : node->right;
         return node;
     }
 
-    TreeNode* search(TreeNode* node, string key) {
-        if (!node || node->key == key) return node;
-        if (key < node->key) return search(node->left, key);
-        return search(node->right, key);
+    // Called after the new root is published. Flipping the epoch sends new
+    // readers to the other counter, so each wait ends; once both counters
+    // have drained, no reader can still hold a pointer into the old tree.
+    void waitForReaders() {
+        for (int pass = 0; pass < 2; pass++) {
+            int old = __atomic_load_n(&epoch, __ATOMIC_SEQ_CST);
+            __atomic_store_n(&epoch, old ^ 1, __ATOMIC_SEQ_CST);
+            while (__atomic_load_n(&readers[old], __ATOMIC_SEQ_CST) != 0) {
+#ifndef _WIN32
+                sched_yield();
+#endif
+            }
+        }
     }
 
 public:
-    BST() : root(NULL) {}
-    void addVariable(string key, double val) { root = insert(root, key, val); }
+    BST() : root(NULL), epoch(0) { readers[0] = readers[1] = 0; }
+    void addVariable(string key, double val) {
+        ScopedLock guard(writeLock);
+        TreeNode* next = insert(__atomic_load_n(&root, __ATOMIC_SEQ_CST), key, val);
+        __atomic_store_n(&root, next, __ATOMIC_SEQ_CST);
+        waitForReaders();
+        for (size_t i = 0; i < retired.size(); i++) delete retired[i];
+        retired.clear();
+    }
+    bool findVariable(string key, double& val) {
+        int e = __atomic_load_n(&epoch, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&readers[e], 1, __ATOMIC_SEQ_CST);
+        TreeNode* res = search(__atomic_load_n(&root, __ATOMIC_SEQ_CST), key);
+        if (res) val = res->value;
+        __atomic_sub_fetch(&readers[e], 1, __ATOMIC_SEQ_CST);
+        return res != NULL;
+    }
     double getVariable(string key) {
-        TreeNode* res = search(root, key);
-        if (res) return res->value;
+        double val;
+        if (findVariable(key, val)) return val;
         cout << "Var not found!" << endl;
         return 0.0;
     }
@@ -205,7 +326,26 @@ public:
 class Graph {
     int V;
     vector<vector<int> > adj; 
+    vector<vector<int> > fanin;     // drivers of each node, in pin order
     vector<string> nodeTypes; 
+    vector<int> topoOrder;          // filled by levelize()
+    vector<char> opCodes;
+
+    enum Op { OP_IN, OP_AND, OP_OR, OP_NAND, OP_NOR, OP_XOR, OP_XNOR, OP_NOT, OP_BUF, OP_CONST0, OP_CONST1 };
+
+    static char opCode(const string& type) {
+        if (type == "AND") return OP_AND;
+        if (type == "OR") return OP_OR;
+        if (type == "NAND") return OP_NAND;
+        if (type == "NOR") return OP_NOR;
+        if (type == "XOR") return OP_XOR;
+        if (type == "XNOR") return OP_XNOR;
+        if (type == "NOT") return OP_NOT;
+        if (type == "BUF") return OP_BUF;
+        if (type == "CONST1") return OP_CONST1;
+        if (type.find("In_") == 0) return OP_IN;
+        return OP_CONST0;
+    }
 
     // Helper to print BIG ASCII Art
     void printGateBlock(string type) {
@@ -239,28 +379,116 @@ class Graph {
             cout << "      )) XOR  )\n";
             cout << "      ))...../ \n";
         }
+        else if (type == "XNOR") {
+            cout << "      ))`````\\\n";
+            cout << "      )) XNOR )o\n";
+            cout << "      ))...../ \n";
+        }
+        else if (type == "BUF") {
+            cout << "      |\\````|\n";
+            cout << "      | BUF >\n";
+            cout << "      |/....| \n";
+        }
         else if (type.find("In_") != string::npos) {
             cout << "   [" << type << "]\n";
         }
     }
 
 public:
-    Graph(int V) : V(V) {
+    Graph(int V = 0) : V(V) {
         adj.resize(V);
+        fanin.resize(V);
         nodeTypes.resize(V);
     }
 
+    int size() const { return V; }
+
+    int addNode(string type) {
+        adj.push_back(vector<int>());
+        fanin.push_back(vector<int>());
+        nodeTypes.push_back(type);
+        return V++;
+    }
+
     void setNodeType(int i, string type) { nodeTypes[i] = type; }
+    const string& getNodeType(int i) const { return nodeTypes[i]; }
+    const vector<int>& getFanin(int i) const { return fanin[i]; }
     
     void addEdge(int u, int v) {
         adj[u].push_back(v); 
+        fanin[v].push_back(u);
     }
 
-    void traceCircuit() {
+    // Orders nodes so every gate comes after its drivers (Kahn's algorithm).
+    // Returns the logic depth, or -1 if the circuit has a feedback loop.
+    int levelize() {
+        vector<int> indeg(V), level(V, 0);
+        topoOrder.clear();
+        opCodes.resize(V);
+        for (int u = 0; u < V; u++) {
+            indeg[u] = fanin[u].size();
+            opCodes[u] = opCode(nodeTypes[u]);
+            if (indeg[u] == 0) topoOrder.push_back(u);
+        }
+        int depth = 0;
+        for (size_t head = 0; head < topoOrder.size(); head++) {
+            int u = topoOrder[head];
+            depth = max(depth, level[u]);
+            for (size_t i = 0; i < adj[u].size(); i++) {
+                int v = adj[u][i];
+                level[v] = max(level[v], level[u] + 1);
+                if (--indeg[v] == 0) topoOrder.push_back(v);
+            }
+        }
+        return (int)topoOrder.size() == V ? depth : -1;
+    }
+
+    // Bit-parallel evaluation: val[i] carries 64 input patterns for node i.
+    // The caller fills the input nodes; levelize() must have been run.
+    void simulate(vector<unsigned long long>& val) const {
+        for (size_t k = 0; k < topoOrder.size(); k++) {
+            int u = topoOrder[k];
+            const vector<int>& in = fanin[u];
+            unsigned long long r = 0;
+            switch (opCodes[u]) {
+                case OP_IN: continue;
+                case OP_CONST1: r = ~0ULL; break;
+                case OP_AND: case OP_NAND:
+                    r = ~0ULL;
+                    for (size_t j = 0; j < in.size(); j++) r &= val[in[j]];
+                    break;
+                case OP_OR: case OP_NOR:
+                    for (size_t j = 0; j < in.size(); j++) r |= val[in[j]];
+                    break;
+                case OP_XOR: case OP_XNOR:
+                    for (size_t j = 0; j < in.size(); j++) r ^= val[in[j]];
+                    break;
+                case OP_NOT: case OP_BUF:
+                    if (!in.empty()) r = val[in[0]];
+                    break;
+            }
+            char op = opCodes[u];
+            if (op == OP_NAND || op == OP_NOR || op == OP_XNOR || op == OP_NOT) r = ~r;
+            val[u] = r;
+        }
+    }
+
+    // Input word for exhaustive simulation: bit b of word w is bit `shift`
+    // of row number w*64+b.
+    static unsigned long long patternWord(int shift, unsigned long long w) {
+        static const unsigned long long masks[6] = {
+            0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+            0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+        };
+        if (shift < 6) return masks[shift];
+        return ((w >> (shift - 6)) & 1) ? ~0ULL : 0ULL;
+    }
+
+    void traceCircuit(int start = 0) {
         vector<bool> visited(V, false);
         vector<int> q; 
-        q.push_back(0); 
-        visited[0] = true;
+        q.push_back(start); 
+        visited[start] = true;
 
         cout << "\n    === LARGE ANSI SCHEMATIC (Vertical Flow) ===\n\n";
         
@@ -410,6 +638,1129 @@ public:
     }
 };
 
+// ==========================================
+// BULK CONVERSION (Streaming)
+// ==========================================
+
+// Converts a whole file of whitespace-separated values between
+// Bin/Oct/Dec/Hex/BCD. The input is read in large blocks and every token
+// is scanned in place as its bytes arrive (a token may straddle two
+// blocks), so no string is built per value. Results are encoded straight
+// into a fixed output buffer; whitespace is copied through unchanged.
+// On POSIX builds with several cores, each read is cut at whitespace into
+// one chunk per thread and the chunk outputs are written back in order.
+class StreamConverter {
+public:
+    static const int BCD = 0;              // radix code for packed BCD
+    static const size_t BLOCK = 1 << 20;   // 1 MB read/write blocks
+
+private:
+    int fromRadix, toRadix;
+    FILE* out;
+    vector<char> inBuf, outBuf;
+    size_t outLen;
+    bool writeFailed;
+
+    // Scan state of the token currently being read
+    bool inToken, bad;
+    unsigned long long value;
+    int nibble, nibbleBits;
+
+    static int digitValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return 99;
+    }
+
+    void addDigit(int d, int radix) {
+        const unsigned long long maxVal = ~0ULL;
+        if (d >= radix || value > (maxVal - d) / radix) { bad = true; return; }
+        value = value * radix + d;
+    }
+
+    void scan(char c) {
+        int d = digitValue(c);
+        if (fromRadix != BCD) { addDigit(d, fromRadix); return; }
+        if (d > 1) { bad = true; return; }
+        nibble = (nibble << 1) | d;
+        if (++nibbleBits == 4) {
+            addDigit(nibble, 10);
+            nibble = nibbleBits = 0;
+        }
+    }
+
+    // Writes the digits of v into the tail of buf, returns the first char
+    static char* encode(unsigned long long v, int radix, char* end) {
+        static const char digits[] = "0123456789ABCDEF";
+        char* p = end;
+        if (radix == BCD) {
+            do {
+                int d = (int)(v % 10);
+                for (int b = 0; b < 4; b++) { *--p = (char)('0' + (d & 1)); d >>= 1; }
+                v /= 10;
+            } while (v > 0);
+            return p;
+        }
+        do {
+            *--p = digits[v % radix];
+            v /= radix;
+        } while (v > 0);
+        return p;
+    }
+
+    static bool isSeparator(char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+    void put(const char* s, size_t n) {
+        if (outLen + n > outBuf.size()) flush();
+        for (size_t i = 0; i < n; i++) outBuf[outLen++] = s[i];
+    }
+
+    // A chunk converter has no file: its buffer grows and is written later
+    void flush() {
+        if (!out) { outBuf.resize(outBuf.size() * 2 + 128); return; }
+        if (outLen && fwrite(&outBuf[0], 1, outLen, out) != outLen) writeFailed = true;
+        outLen = 0;
+    }
+
+    void finishToken() {
+        if (fromRadix == BCD && nibbleBits != 0) bad = true;
+        if (bad) {
+            put("ERR", 3);
+            rejected++;
+        } else {
+            char tmp[96];
+            char* first = encode(value, toRadix, tmp + sizeof(tmp));
+            put(first, tmp + sizeof(tmp) - first);
+            converted++;
+        }
+        inToken = bad = false;
+        value = 0;
+        nibble = nibbleBits = 0;
+    }
+
+    void convert(const char* p, const char* end) {
+        while (p < end) {
+            char c = *p++;
+            if (isSeparator(c)) {
+                if (inToken) finishToken();
+                if (outLen == outBuf.size()) flush();
+                outBuf[outLen++] = c;
+            } else {
+                inToken = true;
+                scan(c);
+            }
+        }
+    }
+
+    void runBlocked(FILE* in) {
+        size_t n;
+        while ((n = fread(&inBuf[0], 1, BLOCK, in)) > 0) convert(&inBuf[0], &inBuf[0] + n);
+        if (inToken) finishToken();
+        flush();
+    }
+
+#ifndef _WIN32
+    struct Chunk {
+        StreamConverter* conv;
+        const char* begin;
+        const char* end;
+    };
+
+    static void* convertChunk(void* arg) {
+        Chunk* c = (Chunk*)arg;
+        c->conv->outLen = 0;
+        c->conv->convert(c->begin, c->end);
+        if (c->conv->inToken) c->conv->finishToken();
+        return NULL;
+    }
+
+    // Reads `workers` blocks at a time. Everything up to the last
+    // whitespace is split into chunks that end on whitespace, so no token
+    // is cut; the unfinished token at the end is carried into the next read.
+    void runChunked(FILE* in, int workers) {
+        vector<char> buf((size_t)workers * BLOCK);
+        vector<StreamConverter> parts(workers, StreamConverter(fromRadix, toRadix, 0));
+        size_t carry = 0;
+        for (;;) {
+            size_t n = fread(&buf[carry], 1, buf.size() - carry, in);
+            size_t total = carry + n;
+            if (total == 0) break;
+            size_t cut = total;
+            if (n > 0) while (cut > 0 && !isSeparator(buf[cut - 1])) cut--;
+            if (cut == 0) {                 // one token fills the buffer
+                carry = total;
+                buf.resize(buf.size() * 2);
+                continue;
+            }
+
+            vector<Chunk> chunks;
+            size_t begin = 0;
+            for (int i = 0; i < workers && begin < cut; i++) {
+                size_t stop = (i == workers - 1) ? cut : max(begin, cut / workers * (i + 1));
+                while (stop < cut && !isSeparator(buf[stop])) stop++;
+                Chunk c = { &parts[i], &buf[0] + begin, &buf[0] + stop };
+                chunks.push_back(c);
+                begin = stop;
+            }
+
+            vector<pthread_t> threads(chunks.size());
+            vector<bool> started(chunks.size(), false);
+            for (size_t i = 1; i < chunks.size(); i++)
+                started[i] = pthread_create(&threads[i], NULL, convertChunk, &chunks[i]) == 0;
+            convertChunk(&chunks[0]);
+            for (size_t i = 1; i < chunks.size(); i++) {
+                if (started[i]) pthread_join(threads[i], NULL);
+                else convertChunk(&chunks[i]);
+            }
+
+            for (size_t i = 0; i < chunks.size(); i++) {
+                StreamConverter& p = *chunks[i].conv;
+                if (p.outLen && fwrite(&p.outBuf[0], 1, p.outLen, out) != p.outLen) writeFailed = true;
+            }
+            carry = total - cut;
+            memmove(&buf[0], &buf[cut], carry);
+        }
+        for (int i = 0; i < workers; i++) {
+            converted += parts[i].converted;
+            rejected += parts[i].rejected;
+        }
+    }
+#endif
+
+public:
+    long converted, rejected;
+
+    StreamConverter(int from, int to, size_t bufSize = BLOCK)
+        : fromRadix(from), toRadix(to), out(NULL), inBuf(bufSize), outBuf(bufSize), outLen(0), writeFailed(false),
+          inToken(false), bad(false), value(0), nibble(0), nibbleBits(0),
+          converted(0), rejected(0) {}
+
+    // False if a file cannot be opened, read or fully written
+    bool run(const char* inPath, const char* outPath) {
+        FILE* in = fopen(inPath, "rb");
+        if (!in) return false;
+        out = fopen(outPath, "wb");
+        if (!out) { fclose(in); return false; }
+
+#ifndef _WIN32
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cpus > 1) runChunked(in, (int)min(cpus, 8L));
+        else
+#endif
+        runBlocked(in);
+        bool ok = !ferror(in) && !writeFailed;
+        fclose(in);
+        if (fclose(out) != 0) ok = false;
+        out = NULL;
+        return ok;
+    }
+};
+
+// ==========================================
+// NETLIST IMPORT (BLIF / Verilog)
+// ==========================================
+
+// Interns net names: each distinct name is stored once in a shared pool
+// and gets a dense id. Lookups take a (pointer, length) view straight
+// from the file buffer, so nothing is copied unless the name is new.
+class NetTable {
+    string pool;
+    vector<int> offset, length;
+    vector<int> slots;              // open addressing, -1 = empty
+
+    static unsigned int hashFunc(const char* p, size_t n) {
+        unsigned int h = 2166136261u;   // FNV-1a
+        for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char)p[i]) * 16777619u;
+        return h;
+    }
+
+    void grow() {
+        vector<int> old(slots.size() * 2, -1);
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (int id = 0; id < size(); id++) {
+            size_t i = hashFunc(pool.data() + offset[id], length[id]) & mask;
+            while (slots[i] != -1) i = (i + 1) & mask;
+            slots[i] = id;
+        }
+    }
+
+public:
+    NetTable() : slots(1024, -1) {}
+
+    int size() const { return offset.size(); }
+    string name(int id) const { return pool.substr(offset[id], length[id]); }
+
+    int intern(const char* p, size_t n) {
+        if (2 * (size_t)(size() + 1) > slots.size()) grow();
+        size_t mask = slots.size() - 1;
+        size_t i = hashFunc(p, n) & mask;
+        while (slots[i] != -1) {
+            int id = slots[i];
+            if ((size_t)length[id] == n && pool.compare(offset[id], n, p, n) == 0) return id;
+            i = (i + 1) & mask;
+        }
+        int id = size();
+        offset.push_back(pool.size());
+        length.push_back(n);
+        pool.append(p, n);
+        slots[i] = id;
+        return id;
+    }
+};
+
+struct Netlist {
+    Graph graph;
+    vector<int> inputs, outputs;
+    vector<string> inputNames, outputNames;
+};
+
+// Single-pass loader for a combinational BLIF subset (.model/.inputs/
+// .outputs/.names/.end) and gate-level Verilog (input/output/wire, the
+// and/or/nand/nor/xor/xnor/not/buf primitives and simple assigns).
+// Every net becomes one Graph node; BLIF covers are split into AND/OR
+// nodes so both formats simulate through the same gate set.
+class NetlistImporter {
+    string buf;
+    const char* p;
+    const char* end;
+    int line;
+    string error;
+
+    NetTable names;
+    vector<int> netNode;            // net id -> graph node
+    vector<char> driven;            // per graph node
+    vector<int> inverter;           // per graph node: shared NOT node, -1 if none
+    Netlist* nl;
+
+    bool fail(string msg) {
+        error = "line " + numToStr(line) + ": " + msg;
+        return false;
+    }
+
+    static bool is(const char* s, size_t n, const char* word) {
+        size_t i = 0;
+        for (; i < n; i++) if (word[i] != s[i]) return false;
+        return word[i] == '\0';
+    }
+
+    int addNode(string type, bool isDriven) {
+        driven.push_back(isDriven);
+        inverter.push_back(-1);
+        return nl->graph.addNode(type);
+    }
+
+    int net(const char* s, size_t n) {
+        int id = names.intern(s, n);
+        if (id == (int)netNode.size()) netNode.push_back(addNode("", false));
+        return netNode[id];
+    }
+
+    bool drive(int u, string type) {
+        if (driven[u]) return fail("net driven more than once");
+        driven[u] = true;
+        nl->graph.setNodeType(u, type);
+        return true;
+    }
+
+    int invert(int u) {
+        if (inverter[u] < 0) {
+            int g = addNode("NOT", true);
+            nl->graph.addEdge(u, g);
+            inverter[u] = g;
+        }
+        return inverter[u];
+    }
+
+    void addInput(const char* s, size_t n) {
+        int u = net(s, n);
+        drive(u, "In_" + string(s, n));
+        nl->inputs.push_back(u);
+        nl->inputNames.push_back(string(s, n));
+    }
+
+    void addOutput(const char* s, size_t n) {
+        nl->outputs.push_back(net(s, n));
+        nl->outputNames.push_back(string(s, n));
+    }
+
+    // --- BLIF ---
+    // Next token on the current logical line ('\\' joins lines).
+    bool blifToken(const char*& s, size_t& n) {
+        for (;;) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            if (p < end && *p == '\\') {
+                const char* q = p + 1;
+                while (q < end && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+                if (q < end && *q == '\n') { p = q + 1; line++; continue; }
+            }
+            if (p >= end || *p == '\n') return false;
+            if (*p == '#') {
+                while (p < end && *p != '\n') p++;
+                return false;
+            }
+            s = p;
+            while (p < end && !isspace((unsigned char)*p) && *p != '#') p++;
+            n = p - s;
+            return true;
+        }
+    }
+
+    void nextLine() {
+        while (p < end && *p != '\n') p++;
+        if (p < end) { p++; line++; }
+    }
+
+    // One .names block: pins[k] is the output, cubes point into buf
+    bool buildCover(const vector<int>& pins, const vector<const char*>& cubes, char polarity) {
+        size_t k = pins.size() - 1;
+        int out = pins[k];
+        if (cubes.empty()) return drive(out, "CONST0");
+
+        if (cubes.size() == 1) {
+            const char* cube = cubes[0];
+            vector<int> care;               // pin positions not marked '-'
+            for (size_t i = 0; i < k; i++)
+                if (cube[i] != '-') care.push_back(i);
+            bool on = polarity == '1';
+            if (care.size() == 1) {
+                bool neg = cube[care[0]] == '0';
+                if (!drive(out, (neg == on) ? "NOT" : "BUF")) return false;
+                nl->graph.addEdge(pins[care[0]], out);
+                return true;
+            }
+            if (care.empty()) return drive(out, on ? "CONST1" : "CONST0");
+            if (!drive(out, on ? "AND" : "NAND")) return false;
+            for (size_t i = 0; i < care.size(); i++) {
+                int pin = pins[care[i]];
+                nl->graph.addEdge(cube[care[i]] == '0' ? invert(pin) : pin, out);
+            }
+            return true;
+        }
+
+        if (!drive(out, polarity == '1' ? "OR" : "NOR")) return false;
+        for (size_t c = 0; c < cubes.size(); c++) {
+            vector<int> lits;
+            for (size_t i = 0; i < k; i++) {
+                if (cubes[c][i] == '1') lits.push_back(pins[i]);
+                else if (cubes[c][i] == '0') lits.push_back(invert(pins[i]));
+            }
+            int term;
+            if (lits.size() == 1) term = lits[0];
+            else {
+                term = addNode(lits.empty() ? "CONST1" : "AND", true);
+                for (size_t i = 0; i < lits.size(); i++) nl->graph.addEdge(lits[i], term);
+            }
+            nl->graph.addEdge(term, out);
+        }
+        return true;
+    }
+
+    bool parseNames() {
+        const char* s;
+        size_t n;
+        vector<int> pins;
+        while (blifToken(s, n)) pins.push_back(net(s, n));
+        if (pins.empty()) return fail(".names without an output");
+        size_t k = pins.size() - 1;
+        nextLine();
+
+        vector<const char*> cubes;
+        char polarity = 0;
+        while (p < end) {
+            const char* mark = p;
+            int markLine = line;
+            if (!blifToken(s, n)) { nextLine(); continue; }
+            if (*s == '.') { p = mark; line = markLine; break; }
+
+            const char* cube = s;
+            if (k > 0) {
+                if (n != k) return fail("cover row width does not match .names inputs");
+                for (size_t i = 0; i < k; i++)
+                    if (s[i] != '0' && s[i] != '1' && s[i] != '-') return fail("bad cover row");
+                if (!blifToken(s, n)) return fail("cover row missing output value");
+            }
+            if (n != 1 || (*s != '0' && *s != '1')) return fail("bad cover output value");
+            if (polarity && polarity != *s) return fail("mixed on-set and off-set rows");
+            polarity = *s;
+            cubes.push_back(cube);
+            nextLine();
+        }
+        return buildCover(pins, cubes, polarity ? polarity : '1');
+    }
+
+    bool parseBlif() {
+        const char* s;
+        size_t n;
+        while (p < end) {
+            if (!blifToken(s, n)) { nextLine(); continue; }
+            if (is(s, n, ".model")) {
+                nextLine();
+            } else if (is(s, n, ".inputs")) {
+                while (blifToken(s, n)) addInput(s, n);
+                if (!error.empty()) return false;
+                nextLine();
+            } else if (is(s, n, ".outputs")) {
+                while (blifToken(s, n)) addOutput(s, n);
+                nextLine();
+            } else if (is(s, n, ".names")) {
+                if (!parseNames()) return false;
+            } else if (is(s, n, ".end")) {
+                break;
+            } else {
+                return fail("unsupported BLIF construct '" + string(s, n) + "'");
+            }
+        }
+        return true;
+    }
+
+    // --- Verilog ---
+    // Next token: identifier/number, or a single punctuation character.
+    bool vToken(const char*& s, size_t& n) {
+        for (;;) {
+            while (p < end && isspace((unsigned char)*p)) {
+                if (*p == '\n') line++;
+                p++;
+            }
+            if (p + 1 < end && p[0] == '/' && p[1] == '/') {
+                while (p < end && *p != '\n') p++;
+            } else if (p + 1 < end && p[0] == '/' && p[1] == '*') {
+                p += 2;
+                while (p + 1 < end && !(p[0] == '*' && p[1] == '/')) {
+                    if (*p == '\n') line++;
+                    p++;
+                }
+                p = min(p + 2, end);
+            } else break;
+        }
+        if (p >= end) return false;
+        s = p;
+        if (*p == '\\') {                 // escaped identifier
+            s = ++p;
+            while (p < end && !isspace((unsigned char)*p)) p++;
+        } else if (isalnum((unsigned char)*p) || *p == '_' || *p == '$' || *p == '\'') {
+            while (p < end && (isalnum((unsigned char)*p) || *p == '_' || *p == '$' || *p == '\'')) p++;
+        } else {
+            p++;
+        }
+        n = p - s;
+        return true;
+    }
+
+    bool expect(char c) {
+        const char* s;
+        size_t n;
+        if (!vToken(s, n) || n != 1 || *s != c) return fail(string("expected '") + c + "'");
+        return true;
+    }
+
+    // Comma-separated names up to `close`. kind 1/2 declares inputs/outputs,
+    // kind 0 just collects the nets into pins.
+    bool nameList(vector<int>& pins, char close, int kind) {
+        const char* s;
+        size_t n;
+        for (;;) {
+            if (!vToken(s, n)) return fail("unexpected end of file");
+            if (n == 1 && *s == '[') return fail("bus declarations are not supported");
+            if (kind == 1) addInput(s, n);
+            else if (kind == 2) addOutput(s, n);
+            else pins.push_back(net(s, n));
+            if (!error.empty()) return false;
+            if (!vToken(s, n)) return fail("unexpected end of file");
+            if (n == 1 && *s == close) return true;
+            if (n != 1 || *s != ',') return fail("expected ',' in name list");
+        }
+    }
+
+    static string primitiveType(const char* s, size_t n) {
+        static const char* prims[] = { "and", "or", "nand", "nor", "xor", "xnor", "not", "buf" };
+        for (int i = 0; i < 8; i++) {
+            if (is(s, n, prims[i])) {
+                string t(prims[i]);
+                for (size_t k = 0; k < t.length(); ++k) t[k] = toupper(t[k]);
+                return t;
+            }
+        }
+        return "";
+    }
+
+    bool parseAssign() {
+        const char* s;
+        size_t n;
+        if (!vToken(s, n)) return fail("unexpected end of file");
+        int out = net(s, n);
+        if (!expect('=')) return false;
+        if (!vToken(s, n)) return fail("unexpected end of file");
+        bool neg = n == 1 && *s == '~';
+        if (neg && !vToken(s, n)) return fail("unexpected end of file");
+
+        if (is(s, n, "1'b0") || is(s, n, "0")) {
+            if (!drive(out, neg ? "CONST1" : "CONST0")) return false;
+        } else if (is(s, n, "1'b1") || is(s, n, "1")) {
+            if (!drive(out, neg ? "CONST0" : "CONST1")) return false;
+        } else if (isalpha((unsigned char)*s) || *s == '_') {
+            int in = net(s, n);
+            if (!drive(out, neg ? "NOT" : "BUF")) return false;
+            nl->graph.addEdge(in, out);
+        } else {
+            return fail("only 'assign a = [~]b' and constants are supported");
+        }
+        if (!vToken(s, n)) return fail("unexpected end of file");
+        if (n == 1 && strchr("&|^~+-*/%?:<>=!([{", *s))      // an expression, not a plain operand
+            return fail("only 'assign a = [~]b' and constants are supported");
+        if (n != 1 || *s != ';') return fail("expected ';'");
+        return true;
+    }
+
+    // Header port list. ANSI declarations ("input a, b, output y") are
+    // taken here; plain names are declared again in the module body.
+    bool parsePortList() {
+        const char* s;
+        size_t n;
+        int kind = 0;                   // 0 plain name, 1 input, 2 output
+        for (;;) {
+            if (!vToken(s, n)) return fail("unexpected end of file");
+            if (n == 1 && *s == ')') return true;
+            if (n == 1 && *s == ',') continue;
+            if (n == 1 && *s == '[') return fail("bus declarations are not supported");
+            if (is(s, n, "input")) kind = 1;
+            else if (is(s, n, "output")) kind = 2;
+            else if (is(s, n, "inout")) return fail("inout ports are not supported");
+            else if (is(s, n, "wire")) continue;
+            else if (kind == 1) addInput(s, n);
+            else if (kind == 2) addOutput(s, n);
+            if (!error.empty()) return false;
+        }
+    }
+
+    bool parseVerilog() {
+        const char* s;
+        size_t n;
+        vector<int> pins;
+        if (!vToken(s, n) || !is(s, n, "module")) return fail("expected 'module'");
+        if (!vToken(s, n)) return fail("expected module name");
+        if (!vToken(s, n)) return fail("unexpected end of file");
+        if (n == 1 && *s == '(') {
+            if (!parsePortList() || !expect(';')) return false;
+        } else if (n != 1 || *s != ';') {
+            return fail("expected port list");
+        }
+
+        while (vToken(s, n)) {
+            string prim;
+            if (is(s, n, "endmodule")) return true;
+            if (is(s, n, "input")) {
+                if (!nameList(pins, ';', 1)) return false;
+            } else if (is(s, n, "output")) {
+                if (!nameList(pins, ';', 2)) return false;
+            } else if (is(s, n, "wire")) {
+                pins.clear();
+                if (!nameList(pins, ';', 0)) return false;
+            } else if (is(s, n, "assign")) {
+                if (!parseAssign()) return false;
+            } else if (!(prim = primitiveType(s, n)).empty()) {
+                if (!vToken(s, n)) return fail("unexpected end of file");
+                if (!(n == 1 && *s == '(') && !expect('(')) return false;   // skip instance name
+                pins.clear();
+                if (!nameList(pins, ')', 0) || !expect(';')) return false;
+                if (pins.size() < 2) return fail(prim + " needs an output and an input");
+                if ((prim == "NOT" || prim == "BUF") && pins.size() != 2) return fail(prim + " takes one input");
+                if (!drive(pins[0], prim)) return false;
+                for (size_t i = 1; i < pins.size(); i++) nl->graph.addEdge(pins[i], pins[0]);
+            } else {
+                return fail("unsupported Verilog construct '" + string(s, n) + "'");
+            }
+        }
+        return fail("missing 'endmodule'");
+    }
+
+public:
+    NetlistImporter() : p(NULL), end(NULL), line(1), nl(NULL) {}
+
+    bool load(string path, Netlist& out, string& err) {
+        nl = &out;
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) { err = "cannot open " + path; return false; }
+        char chunk[65536];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) buf.append(chunk, got);
+        bool readOk = !ferror(f);
+        fclose(f);
+        if (!readOk) { err = "cannot read " + path; return false; }
+        p = buf.data();
+        end = p + buf.size();
+
+        size_t dot = path.rfind('.');
+        string ext = dot == string::npos ? "" : path.substr(dot);
+        bool ok;
+        if (ext == ".blif") ok = parseBlif();
+        else if (ext == ".v") ok = parseVerilog();
+        else { err = "unknown netlist format (use .blif or .v)"; return false; }
+        if (!ok) { err = error; return false; }
+
+        // Declared but unused nets may dangle; only nets that are read need a driver
+        vector<char> isRead(nl->graph.size(), 0);
+        for (int u = 0; u < nl->graph.size(); u++) {
+            const vector<int>& in = nl->graph.getFanin(u);
+            for (size_t i = 0; i < in.size(); i++) isRead[in[i]] = 1;
+        }
+        for (size_t k = 0; k < nl->outputs.size(); k++) isRead[nl->outputs[k]] = 1;
+        for (int id = 0; id < names.size(); id++) {
+            if (!driven[netNode[id]] && isRead[netNode[id]]) {
+                err = "net '" + names.name(id) + "' has no driver";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ==========================================
+// EQUIVALENCE CHECKING
+// ==========================================
+
+// Small CDCL SAT solver: two watched literals, first-UIP clause learning
+// with backjumping, VSIDS activities and phase saving. Literal 2v is
+// variable v, 2v+1 its negation.
+class SatSolver {
+    vector<vector<int> > clauses;
+    vector<vector<int> > watches;       // literal -> clauses watching it
+    vector<signed char> assigns;        // -1 unassigned, else 0/1
+    vector<signed char> phase;
+    vector<int> level, reason;
+    vector<int> trail, trailLim;
+    size_t qhead;
+    vector<double> activity;
+    double varInc;
+    vector<int> heap, heapPos;          // max-heap of variables by activity
+    vector<char> seen;
+    bool unsat;
+
+    int value(int lit) const {
+        int a = assigns[lit >> 1];
+        return a < 0 ? -1 : (a ^ (lit & 1));
+    }
+
+    int decisionLevel() const { return trailLim.size(); }
+
+    void enqueue(int lit, int from) {
+        int v = lit >> 1;
+        assigns[v] = !(lit & 1);
+        level[v] = decisionLevel();
+        reason[v] = from;
+        trail.push_back(lit);
+    }
+
+    // --- heap helpers ---
+    void heapSwap(int i, int j) {
+        swap(heap[i], heap[j]);
+        heapPos[heap[i]] = i;
+        heapPos[heap[j]] = j;
+    }
+
+    void siftUp(int i) {
+        while (i > 0 && activity[heap[(i - 1) / 2]] < activity[heap[i]]) {
+            heapSwap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void siftDown(int i) {
+        int n = heap.size();
+        for (;;) {
+            int l = 2 * i + 1, r = l + 1, best = i;
+            if (l < n && activity[heap[l]] > activity[heap[best]]) best = l;
+            if (r < n && activity[heap[r]] > activity[heap[best]]) best = r;
+            if (best == i) return;
+            heapSwap(i, best);
+            i = best;
+        }
+    }
+
+    void heapInsert(int v) {
+        if (heapPos[v] >= 0) return;
+        heapPos[v] = heap.size();
+        heap.push_back(v);
+        siftUp(heapPos[v]);
+    }
+
+    int heapPop() {
+        int v = heap[0];
+        heapSwap(0, heap.size() - 1);
+        heap.pop_back();
+        heapPos[v] = -1;
+        if (!heap.empty()) siftDown(0);
+        return v;
+    }
+
+    void bump(int v) {
+        if ((activity[v] += varInc) > 1e100) {
+            for (size_t i = 0; i < activity.size(); i++) activity[i] *= 1e-100;
+            varInc *= 1e-100;
+        }
+        if (heapPos[v] >= 0) siftUp(heapPos[v]);
+    }
+
+    void watch(int ci) {
+        watches[clauses[ci][0]].push_back(ci);
+        watches[clauses[ci][1]].push_back(ci);
+    }
+
+    // Returns the conflicting clause, or -1
+    int propagate() {
+        while (qhead < trail.size()) {
+            int falseLit = trail[qhead++] ^ 1;
+            vector<int>& ws = watches[falseLit];
+            size_t i = 0, j = 0;
+            while (i < ws.size()) {
+                int ci = ws[i++];
+                vector<int>& c = clauses[ci];
+                if (c[0] == falseLit) swap(c[0], c[1]);
+                if (value(c[0]) == 1) { ws[j++] = ci; continue; }
+
+                bool moved = false;
+                for (size_t k = 2; k < c.size(); k++) {
+                    if (value(c[k]) != 0) {
+                        swap(c[1], c[k]);
+                        watches[c[1]].push_back(ci);
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved) continue;
+
+                ws[j++] = ci;
+                if (value(c[0]) == 0) {
+                    while (i < ws.size()) ws[j++] = ws[i++];
+                    ws.resize(j);
+                    qhead = trail.size();
+                    return ci;
+                }
+                enqueue(c[0], ci);
+            }
+            ws.resize(j);
+        }
+        return -1;
+    }
+
+    // First-UIP learning; learnt[0] is the asserting literal
+    int analyze(int confl, vector<int>& learnt) {
+        learnt.assign(1, 0);
+        int pathC = 0, p = -1;
+        int idx = trail.size() - 1;
+        do {
+            const vector<int>& c = clauses[confl];
+            for (size_t j = (p == -1 ? 0 : 1); j < c.size(); j++) {
+                int v = c[j] >> 1;
+                if (seen[v] || level[v] == 0) continue;
+                seen[v] = 1;
+                bump(v);
+                if (level[v] >= decisionLevel()) pathC++;
+                else learnt.push_back(c[j]);
+            }
+            while (!seen[trail[idx] >> 1]) idx--;
+            p = trail[idx--];
+            confl = reason[p >> 1];
+            seen[p >> 1] = 0;
+            pathC--;
+        } while (pathC > 0);
+        learnt[0] = p ^ 1;
+
+        int btLevel = 0;
+        for (size_t i = 1; i < learnt.size(); i++) {
+            seen[learnt[i] >> 1] = 0;
+            if (level[learnt[i] >> 1] > btLevel) {
+                btLevel = level[learnt[i] >> 1];
+                swap(learnt[1], learnt[i]);
+            }
+        }
+        return btLevel;
+    }
+
+    void backtrack(int lvl) {
+        if (decisionLevel() <= lvl) return;
+        for (int i = trail.size() - 1; i >= trailLim[lvl]; i--) {
+            int v = trail[i] >> 1;
+            phase[v] = assigns[v];
+            assigns[v] = -1;
+            heapInsert(v);
+        }
+        trail.resize(trailLim[lvl]);
+        trailLim.resize(lvl);
+        qhead = trail.size();
+    }
+
+public:
+    SatSolver() : qhead(0), varInc(1.0), unsat(false) {}
+
+    int newVar() {
+        int v = assigns.size();
+        assigns.push_back(-1);
+        phase.push_back(0);
+        level.push_back(0);
+        reason.push_back(-1);
+        activity.push_back(0.0);
+        seen.push_back(0);
+        heapPos.push_back(-1);
+        watches.resize(2 * (v + 1));
+        heapInsert(v);
+        return v;
+    }
+
+    void addClause(vector<int> lits) {
+        if (unsat) return;
+        sort(lits.begin(), lits.end());
+        size_t j = 0;
+        for (size_t i = 0; i < lits.size(); i++) {
+            if (i > 0 && lits[i] == lits[i - 1]) continue;
+            if (i > 0 && lits[i] == (lits[i - 1] ^ 1)) return;     // tautology
+            if (value(lits[i]) == 1) return;
+            if (value(lits[i]) == 0) continue;
+            lits[j++] = lits[i];
+        }
+        lits.resize(j);
+        if (lits.empty()) { unsat = true; return; }
+        if (lits.size() == 1) { enqueue(lits[0], -1); return; }
+        clauses.push_back(lits);
+        watch(clauses.size() - 1);
+    }
+
+    // 1 = satisfiable, 0 = unsatisfiable, -1 = conflict budget exhausted
+    int solve(long budget) {
+        if (unsat || propagate() != -1) return 0;
+        vector<int> learnt;
+        long conflicts = 0;
+        for (;;) {
+            int confl = propagate();
+            if (confl != -1) {
+                if (decisionLevel() == 0) return 0;
+                if (++conflicts > budget) return -1;
+                int bt = analyze(confl, learnt);
+                backtrack(bt);
+                if (learnt.size() == 1) {
+                    enqueue(learnt[0], -1);
+                } else {
+                    clauses.push_back(learnt);
+                    watch(clauses.size() - 1);
+                    enqueue(learnt[0], clauses.size() - 1);
+                }
+                varInc *= 1.0 / 0.95;
+            } else {
+                int v = -1;
+                while (!heap.empty()) {
+                    v = heapPop();
+                    if (assigns[v] < 0) break;
+                    v = -1;
+                }
+                if (v < 0) return 1;
+                trailLim.push_back(trail.size());
+                enqueue(2 * v + (phase[v] ? 0 : 1), -1);
+            }
+        }
+    }
+
+    bool modelValue(int v) const { return assigns[v] == 1; }
+};
+
+// Checks whether two netlists compute the same outputs. Inputs/outputs
+// with the same name are paired; pins left over on both sides are paired
+// in order, so circuits with no common names pair by position. Up to 20
+// inputs every pattern is simulated (64 per pass); beyond that random
+// patterns hunt for a difference and a SAT miter proves equivalence.
+class EquivalenceChecker {
+    Netlist& a;
+    Netlist& b;
+    vector<unsigned long long> va, vb;
+
+    static bool pairUp(const vector<string>& na, const vector<string>& nb, vector<int>& m) {
+        if (na.size() != nb.size()) return false;
+        m.assign(na.size(), -1);
+        vector<bool> used(nb.size(), false);
+        for (size_t i = 0; i < na.size(); i++) {
+            for (size_t k = 0; k < nb.size(); k++) {
+                if (!used[k] && nb[k] == na[i]) {
+                    m[i] = k;
+                    used[k] = true;
+                    break;
+                }
+            }
+        }
+        size_t next = 0;                    // leftovers pair up in order
+        for (size_t i = 0; i < na.size(); i++) {
+            if (m[i] >= 0) continue;
+            while (used[next]) next++;
+            m[i] = next;
+            used[next] = true;
+        }
+        return true;
+    }
+
+    // Simulates one word of input patterns; returns the mismatch mask
+    unsigned long long compare() {
+        for (size_t j = 0; j < inMap.size(); j++) vb[b.inputs[inMap[j]]] = va[a.inputs[j]];
+        a.graph.simulate(va);
+        b.graph.simulate(vb);
+        unsigned long long diff = 0;
+        for (size_t k = 0; k < outMap.size(); k++) diff |= va[a.outputs[k]] ^ vb[b.outputs[outMap[k]]];
+        return diff;
+    }
+
+    bool recordCounterexample(unsigned long long diff) {
+        if (!diff) return false;
+        int bit = 0;
+        while (!((diff >> bit) & 1)) bit++;
+        for (size_t j = 0; j < a.inputs.size(); j++) cex.push_back((va[a.inputs[j]] >> bit) & 1);
+        for (size_t k = 0; k < outMap.size(); k++) {
+            outA.push_back((va[a.outputs[k]] >> bit) & 1);
+            outB.push_back((vb[b.outputs[outMap[k]]] >> bit) & 1);
+        }
+        return true;
+    }
+
+    int exhaustive() {
+        int n = a.inputs.size();
+        unsigned long long rows = 1ULL << n;
+        method = "Exhaustive";
+        for (unsigned long long w = 0; w * 64 < rows; w++) {
+            for (int j = 0; j < n; j++) va[a.inputs[j]] = Graph::patternWord(n - 1 - j, w);
+            unsigned long long diff = compare();
+            if (rows < 64) diff &= (1ULL << rows) - 1;
+            patterns += rows < 64 ? rows : 64;
+            if (diff) { recordCounterexample(diff); return DIFFERENT; }
+        }
+        return EQUIVALENT;
+    }
+
+    int randomSim(int words) {
+        unsigned long long x = 88172645463325252ULL;       // xorshift64
+        method = "Random";
+        for (int w = 0; w < words; w++) {
+            for (size_t j = 0; j < a.inputs.size(); j++) {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                va[a.inputs[j]] = x;
+            }
+            patterns += 64;
+            unsigned long long diff = compare();
+            if (diff) { recordCounterexample(diff); return DIFFERENT; }
+        }
+        return UNKNOWN;
+    }
+
+    static void addXor(SatSolver& s, int c, int x, int y) {   // c <-> x ^ y
+        int cl[4][3] = { { c ^ 1, x, y }, { c ^ 1, x ^ 1, y ^ 1 }, { c, x ^ 1, y }, { c, x, y ^ 1 } };
+        for (int i = 0; i < 4; i++) s.addClause(vector<int>(cl[i], cl[i] + 3));
+    }
+
+    static void addEquiv(SatSolver& s, int x, int y) {
+        vector<int> c(2);
+        c[0] = x ^ 1; c[1] = y; s.addClause(c);
+        c[0] = x; c[1] = y ^ 1; s.addClause(c);
+    }
+
+    // Tseitin clauses for every gate; var[u] must already hold the inputs
+    static void encode(SatSolver& s, const Graph& g, vector<int>& var) {
+        for (int u = 0; u < g.size(); u++)
+            if (var[u] < 0) var[u] = s.newVar();
+
+        for (int u = 0; u < g.size(); u++) {
+            const string& type = g.getNodeType(u);
+            if (type.find("In_") == 0) continue;
+            const vector<int>& in = g.getFanin(u);
+            int y = 2 * var[u];
+            vector<int> c;
+
+            if (type == "AND" || type == "NAND" || type == "OR" || type == "NOR") {
+                // AND: (~t | x_i) and (t | ~x_1 | ... | ~x_k); OR is the dual (f = 1)
+                int t = (type == "NAND" || type == "NOR") ? y ^ 1 : y;
+                int f = (type == "OR" || type == "NOR") ? 1 : 0;
+                vector<int> big(1, t ^ f);
+                for (size_t i = 0; i < in.size(); i++) {
+                    int x = 2 * var[in[i]];
+                    c.assign(1, t ^ 1 ^ f);
+                    c.push_back(x ^ f);
+                    s.addClause(c);
+                    big.push_back(x ^ 1 ^ f);
+                }
+                s.addClause(big);
+            } else if (type == "XOR" || type == "XNOR") {
+                int t = type == "XNOR" ? y ^ 1 : y;
+                if (in.empty()) { s.addClause(vector<int>(1, t ^ 1)); continue; }
+                int acc = 2 * var[in[0]];
+                if (in.size() == 1) { addEquiv(s, t, acc); continue; }
+                for (size_t i = 1; i < in.size(); i++) {
+                    int out = (i + 1 == in.size()) ? t : 2 * s.newVar();
+                    addXor(s, out, acc, 2 * var[in[i]]);
+                    acc = out;
+                }
+            } else if (type == "NOT" || type == "BUF") {
+                int t = type == "NOT" ? y ^ 1 : y;
+                if (in.empty()) s.addClause(vector<int>(1, t ^ 1));
+                else addEquiv(s, t, 2 * var[in[0]]);
+            } else if (type == "CONST1") {
+                s.addClause(vector<int>(1, y));
+            } else {
+                s.addClause(vector<int>(1, y ^ 1));
+            }
+        }
+    }
+
+    int prove(long budget) {
+        SatSolver s;
+        vector<int> varA(a.graph.size(), -1), varB(b.graph.size(), -1);
+        for (size_t j = 0; j < a.inputs.size(); j++) {
+            varA[a.inputs[j]] = s.newVar();
+            varB[b.inputs[inMap[j]]] = varA[a.inputs[j]];
+        }
+        encode(s, a.graph, varA);
+        encode(s, b.graph, varB);
+
+        // Miter: at least one output pair differs
+        vector<int> anyDiff;
+        for (size_t k = 0; k < outMap.size(); k++) {
+            int d = 2 * s.newVar();
+            addXor(s, d, 2 * varA[a.outputs[k]], 2 * varB[b.outputs[outMap[k]]]);
+            anyDiff.push_back(d);
+        }
+        s.addClause(anyDiff);
+
+        method = "Random + SAT";
+        int r = s.solve(budget);
+        if (r == 0) return EQUIVALENT;
+        if (r < 0) return UNKNOWN;
+
+        for (size_t j = 0; j < a.inputs.size(); j++)
+            va[a.inputs[j]] = s.modelValue(varA[a.inputs[j]]) ? ~0ULL : 0ULL;
+        if (recordCounterexample(compare())) return DIFFERENT;
+        error = "SAT model did not reproduce in simulation";
+        return UNKNOWN;
+    }
+
+public:
+    enum { DIFFERENT, EQUIVALENT, UNKNOWN };
+
+    string method, error;
+    unsigned long long patterns;
+    vector<int> inMap, outMap;          // index in b for each index in a
+    vector<int> cex, outA, outB;        // failing input vector and both outputs
+
+    EquivalenceChecker(Netlist& a, Netlist& b) : a(a), b(b), patterns(0) {}
+
+    int run() {
+        if (!pairUp(a.inputNames, b.inputNames, inMap)) { error = "circuits have different input counts"; return UNKNOWN; }
+        if (!pairUp(a.outputNames, b.outputNames, outMap)) { error = "circuits have different output counts"; return UNKNOWN; }
+        if (a.graph.levelize() < 0 || b.graph.levelize() < 0) { error = "combinational loop"; return UNKNOWN; }
+        va.assign(a.graph.size(), 0);
+        vb.assign(b.graph.size(), 0);
+
+        if (a.inputs.size() <= 20) return exhaustive();
+        if (randomSim(1024) == DIFFERENT) return DIFFERENT;
+        return prove(20000);
+    }
+};
+
 // ==========================================
 // CALCULATOR LOGIC
 // ==========================================
@@ -421,6 +1772,13 @@ class Calculator {
     BST variableStore;
     HashTable commandHelp;
 
+    // History belongs to the interactive session; server requests are
+    // not recorded, so it never needs a lock.
+    void record(string op, int result, string log = "") {
+        history.append(op, result);
+        if (!log.empty()) sessionLog.addLog(log);
+    }
+
 public:
     Calculator() {
         commandHelp.insert("1", "Arithmetic: Performs +, -, *, / on two decimal inputs.");
@@ -430,27 +1788,33 @@ public:
         commandHelp.insert("5", "Variables: Stores/Retrieves values using a BST.");
         commandHelp.insert("6", "Circuit Model: Builds a custom circuit and Truth Table.");
         commandHelp.insert("7", "Sort History: Sorts past results using 4 algorithms.");
+        commandHelp.insert("9", "Bulk Conversion: Streams a file of Bin/Oct/Dec/Hex/BCD values into another file.");
+        commandHelp.insert("10", "Netlist Import: Loads a BLIF or gate-level Verilog circuit and simulates it.");
+        commandHelp.insert("11", "Equivalence Check: Tests whether two circuits compute the same outputs.");
     }
 
     // --- 1. Arithmetic (CYAN) ---
-    void arithmetic() {
-        double a, b;
-        char op;
-        cout << CYAN << "Enter expression (e.g., 5 + 3): " << RESET;
-        cin >> a >> op >> b;
+    double evalArithmetic(double a, char op, double b) const {
         double res = 0;
         if (op == '+') res = a + b;
         else if (op == '-') res = a - b;
         else if (op == '*') res = a * b;
         else if (op == '/') res = (b != 0) ? a / b : 0;
+        return res;
+    }
+
+    void arithmetic() {
+        double a, b;
+        char op;
+        cout << CYAN << "Enter expression (e.g., 5 + 3): " << RESET;
+        cin >> a >> op >> b;
+        double res = evalArithmetic(a, op, b);
+        record(numToStr(a) + op + numToStr(b), (int)res, "Arith");
         
         cout << CYAN << "\n Result Table \n";
         cout << " Input A | Op | Input B | Result \n";
         cout << "---------|----|---------|--------\n";
         cout << " " << setw(7) << a << " | " << op << "  | " << setw(7) << b << " | " << res << endl << RESET;
-        
-        history.append(numToStr(a) + op + numToStr(b), (int)res);
-        sessionLog.addLog("Arith");
     }
 
     // --- 2. Base Conversion (YELLOW) ---
@@ -479,6 +1843,17 @@ public:
         return res;
     }
 
+    // Non-interactive form used by the server; bases 2, 8 and 10
+    bool convertBase(string value, int from, int to, string& result) {
+        if ((from != 2 && from != 8 && from != 10) || (to != 2 && to != 8 && to != 10)) return false;
+        if (value.empty() || value.length() > 9) return false;
+        for (size_t i = 0; i < value.length(); i++)
+            if (value[i] < '0' || value[i] - '0' >= from) return false;
+        int dec = (from == 10) ? strToNum(value) : toDecimal(value, from);
+        result = (to == 10) ? numToStr(dec) : fromDecimal(dec, to);
+        return true;
+    }
+
     void baseConversion() {
         cout << YELLOW << "\n--- Base Conversion ---\n";
         cout << "1. Decimal -> Binary\n";
@@ -512,7 +1887,7 @@ public:
         cout << "------------|-------|--------\n";
         cout << " " << setw(10) << inputStr << " | " << mode << "     | " << result << endl << RESET;
 
-        history.append("BaseConv", strToNum(result));
+        record("BaseConv", strToNum(result));
     }
 
     // --- 3. BCD Conversion (MAGENTA) ---
@@ -559,12 +1934,15 @@ public:
     }
 
     // --- 5. Variable Manager (BLUE) ---
+    void storeVariable(string name, double val) { variableStore.addVariable(name, val); }
+    bool lookupVariable(string name, double& val) { return variableStore.findVariable(name, val); }
+
     void variableManager() {
         string name;
         double val;
         cout << BLUE << "Enter Variable Name: " << RESET; cin >> name;
         cout << BLUE << "Enter Value: " << RESET; cin >> val;
-        variableStore.addVariable(name, val);
+        storeVariable(name, val);
         cout << BLUE << "Saved. Retrieve " << name << ": " << variableStore.getVariable(name) << endl << RESET;
     }
 
@@ -575,41 +1953,57 @@ public:
         if(type == "NAND") return !(a & b);
         if(type == "NOR") return !(a | b);
         if(type == "XOR") return a ^ b;
+        if(type == "XNOR") return !(a ^ b);
+        if(type == "NOT") return !a;
+        if(type == "BUF") return a;
         return 0;
     }
 
-    void showCircuit() {
-        int numInputs;
-        cout << RED << "\n--- Dynamic Circuit Builder ---\n";
-        cout << "How many input variables? (e.g., 3 for A, B, C): " << RESET;
+    // Reads the input count and one gate type per chain stage
+    bool promptChain(int& numInputs, vector<string>& gateTypes) {
+        cout << RED << "How many input variables? (e.g., 3 for A, B, C): " << RESET;
         cin >> numInputs;
 
         if (numInputs < 2) {
             cout << RED << "Need at least 2 inputs for a circuit.\n" << RESET;
-            return;
+            return false;
         }
 
         int numGates = numInputs - 1; 
-        vector<string> gateTypes(numGates);
+        gateTypes.assign(numGates, "");
         
         cout << RED << "We need " << numGates << " gates to combine these inputs.\n";
-        cout << "Available Gates: AND, OR, NAND, NOR, XOR, NOT\n" << RESET;
+        cout << "Available Gates: AND, OR, NAND, NOR, XOR, XNOR, NOT, BUF\n" << RESET;
 
-        Graph circuit(numInputs + numGates); 
-        
+        static const string known = " AND OR NAND NOR XOR XNOR NOT BUF ";
         for(int i=0; i<numGates; i++) {
             cout << RED << "Select Logic for Gate " << (i+1) << ": " << RESET;
-            cin >> gateTypes[i];
+            if (!(cin >> gateTypes[i])) return false;
             // Uppercase conversion
             for (size_t k = 0; k < gateTypes[i].length(); ++k)
                 gateTypes[i][k] = toupper(gateTypes[i][k]);
+            // Options 6 and 11 must agree, so only gates both can evaluate are taken
+            if (known.find(" " + gateTypes[i] + " ") == string::npos) {
+                cout << RED << "Unknown gate '" << gateTypes[i] << "'.\n" << RESET;
+                i--;
+            }
         }
+        return true;
+    }
+
+    // Gate i combines the running result with input i+1 (A, B, C, ...)
+    void buildChainNetlist(int numInputs, const vector<string>& gateTypes, Netlist& nl) {
+        int numGates = numInputs - 1;
+        nl.graph = Graph(numInputs + numGates);
+        Graph& circuit = nl.graph;
 
         // Build Schematic
         for(int i=0; i<numInputs; i++) {
             string name = "In_";
             name += (char)('A' + i);
             circuit.setNodeType(i, name);
+            nl.inputs.push_back(i);
+            nl.inputNames.push_back(name.substr(3));
         }
         
         // Input A -> Gate 1
@@ -622,9 +2016,23 @@ public:
              circuit.addEdge(numInputs + i - 1, numInputs + i);
              circuit.addEdge(i + 1, numInputs + i);
         }
+
+        nl.outputs.push_back(numInputs + numGates - 1);
+        nl.outputNames.push_back("Out");
+    }
+
+    void showCircuit() {
+        int numInputs;
+        vector<string> gateTypes;
+        cout << RED << "\n--- Dynamic Circuit Builder ---\n";
+        if (!promptChain(numInputs, gateTypes)) return;
+        int numGates = numInputs - 1; 
+
+        Netlist chain;
+        buildChainNetlist(numInputs, gateTypes, chain);
         
         cout << RED;
-        circuit.traceCircuit();
+        chain.graph.traceCircuit();
         cout << RESET;
 
         // Generate Custom Truth Table
@@ -685,19 +2093,676 @@ public:
     }
     
     // --- 8. Help (YELLOW) ---
+    string helpText(string cmd) { return commandHelp.get(cmd); }
+
     void help() {
         string cmd;
-        cout << YELLOW << "\nEnter Module Number (1-7) to get help: " << RESET;
+        cout << YELLOW << "\nEnter Module Number (1-11) to get help: " << RESET;
         cin >> cmd;
         cout << YELLOW << "\n[Module " << cmd << "]: " << commandHelp.get(cmd) << endl << RESET;
     }
+
+    // --- 9. Bulk File Conversion (YELLOW) ---
+    int selectFormat(string prompt) {
+        static const int radix[] = { 2, 8, 10, 16, StreamConverter::BCD };
+        cout << YELLOW << prompt << " 1.Bin 2.Oct 3.Dec 4.Hex 5.BCD\n> " << RESET;
+        int f; cin >> f;
+        if (f < 1 || f > 5) return -1;
+        return radix[f - 1];
+    }
+
+    void bulkConversion() {
+        string inPath, outPath;
+        cout << YELLOW << "\n--- Bulk File Conversion ---\n";
+        cout << "Input file: " << RESET; cin >> inPath;
+        cout << YELLOW << "Output file: " << RESET; cin >> outPath;
+
+        int from = selectFormat("Source format:");
+        int to = selectFormat("Target format:");
+        if (from < 0 || to < 0) { cout << "Invalid format.\n"; return; }
+
+        StreamConverter conv(from, to);
+        clock_t start = clock();
+        if (!conv.run(inPath.c_str(), outPath.c_str())) {
+            cout << YELLOW << "Conversion failed: could not read the input or write the output file.\n" << RESET;
+            return;
+        }
+        double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        cout << YELLOW << "\n Bulk Conversion Result \n";
+        cout << " Converted  | Rejected | Time (s) \n";
+        cout << "------------|----------|---------\n";
+        cout << " " << setw(10) << conv.converted << " | " << setw(8) << conv.rejected << " | " << secs << endl << RESET;
+
+        record("BulkConv", (int)conv.converted, "Bulk");
+    }
+
+    // --- 10. Netlist Import (RED) ---
+    void printNetlistTruthTable(Netlist& nl) {
+        int n = nl.inputs.size();
+        cout << RED << "\n--- Calculated Truth Table ---\n";
+        for (int j = 0; j < n; j++) cout << " " << nl.inputNames[j] << " |";
+        for (size_t k = 0; k < nl.outputs.size(); k++) cout << " " << nl.outputNames[k] << " |";
+        cout << "\n";
+        for (int j = 0; j < n; j++) cout << string(nl.inputNames[j].length() + 2, '-') << "|";
+        for (size_t k = 0; k < nl.outputs.size(); k++) cout << string(nl.outputNames[k].length() + 2, '-') << "|";
+        cout << "\n";
+
+        // 64 rows per simulation pass
+        long totalRows = 1L << n;
+        vector<unsigned long long> val(nl.graph.size());
+        for (long w = 0; w * 64 < totalRows; w++) {
+            for (int j = 0; j < n; j++) val[nl.inputs[j]] = Graph::patternWord(n - 1 - j, w);
+            nl.graph.simulate(val);
+            for (int b = 0; b < 64 && w * 64 + b < totalRows; b++) {
+                for (int j = 0; j < n; j++)
+                    cout << " " << setw(nl.inputNames[j].length()) << ((val[nl.inputs[j]] >> b) & 1) << " |";
+                for (size_t k = 0; k < nl.outputs.size(); k++)
+                    cout << " " << setw(nl.outputNames[k].length()) << ((val[nl.outputs[k]] >> b) & 1) << " |";
+                cout << "\n";
+            }
+        }
+        cout << RESET;
+    }
+
+    void importNetlist() {
+        string path;
+        cout << RED << "\n--- Netlist Import (BLIF / Verilog) ---\n";
+        cout << "Netlist file (.blif or .v): " << RESET;
+        cin >> path;
+
+        Netlist nl;
+        NetlistImporter importer;
+        string err;
+        clock_t start = clock();
+        if (!importer.load(path, nl, err)) {
+            cout << RED << "Import failed: " << err << endl << RESET;
+            return;
+        }
+        int depth = nl.graph.levelize();
+        double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+        if (depth < 0) {
+            cout << RED << "Circuit has a combinational loop; cannot simulate.\n" << RESET;
+            return;
+        }
+
+        cout << RED << "\n Netlist Summary \n";
+        cout << " Inputs  | Outputs | Gates      | Depth | Time (s) \n";
+        cout << "---------|---------|------------|-------|---------\n";
+        cout << " " << setw(7) << nl.inputs.size() << " | " << setw(7) << nl.outputs.size() << " | "
+             << setw(10) << (nl.graph.size() - (int)nl.inputs.size()) << " | " << setw(5) << depth
+             << " | " << secs << endl << RESET;
+
+        if (nl.graph.size() <= 40 && !nl.inputs.empty()) {
+            cout << RED;
+            nl.graph.traceCircuit(nl.inputs[0]);
+            cout << RESET;
+        }
+        if (nl.inputs.size() <= 10) printNetlistTruthTable(nl);
+        else cout << RED << "Too many inputs for a full truth table (max 10).\n" << RESET;
+
+        record("Netlist", nl.graph.size(), "Netlist");
+    }
+
+    // --- 11. Equivalence Check (GREEN) ---
+    bool loadCircuit(int which, Netlist& nl) {
+        cout << GREEN << "Circuit " << which << ": 1.Build gate chain  2.Load netlist file\n> " << RESET;
+        int src; cin >> src;
+        if (src == 1) {
+            int numInputs;
+            vector<string> gateTypes;
+            if (!promptChain(numInputs, gateTypes)) return false;
+            buildChainNetlist(numInputs, gateTypes, nl);
+            return true;
+        }
+        if (src == 2) {
+            string path, err;
+            cout << GREEN << "Netlist file (.blif or .v): " << RESET;
+            cin >> path;
+            NetlistImporter importer;
+            if (importer.load(path, nl, err)) return true;
+            cout << GREEN << "Import failed: " << err << endl << RESET;
+            return false;
+        }
+        cout << "Invalid choice.\n";
+        return false;
+    }
+
+    void printPairing(string label, const vector<string>& na, const vector<string>& nb, const vector<int>& m) {
+        bool byName = true;
+        for (size_t i = 0; i < m.size(); i++) if (na[i] != nb[m[i]]) byName = false;
+        cout << GREEN << " " << label << " paired";
+        if (byName) { cout << " by name.\n" << RESET; return; }
+        cout << ":";
+        for (size_t i = 0; i < m.size(); i++) cout << " " << na[i] << "<->" << nb[m[i]];
+        cout << "\n" << RESET;
+    }
+
+    void equivalenceCheck() {
+        cout << GREEN << "\n--- Equivalence Check ---\n" << RESET;
+        Netlist first, second;
+        if (!loadCircuit(1, first) || !loadCircuit(2, second)) return;
+
+        EquivalenceChecker checker(first, second);
+        clock_t start = clock();
+        int verdict = checker.run();
+        double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+        if (!checker.error.empty()) {
+            cout << GREEN << "Cannot compare: " << checker.error << endl << RESET;
+            return;
+        }
+
+        printPairing("Inputs", first.inputNames, second.inputNames, checker.inMap);
+        printPairing("Outputs", first.outputNames, second.outputNames, checker.outMap);
+
+        string result = verdict == EquivalenceChecker::EQUIVALENT ? "EQUIVALENT"
+                      : verdict == EquivalenceChecker::DIFFERENT ? "DIFFERENT" : "UNDECIDED";
+        cout << GREEN << "\n Equivalence Result \n";
+        cout << " Method        | Patterns     | Time (s) | Result \n";
+        cout << "---------------|--------------|----------|-----------\n";
+        cout << " " << setw(13) << left << checker.method << right << " | " << setw(12) << checker.patterns
+             << " | " << setw(8) << secs << " | " << result << endl;
+
+        if (verdict == EquivalenceChecker::DIFFERENT) {
+            cout << "\n Counterexample:";
+            for (size_t j = 0; j < first.inputs.size(); j++)
+                cout << " " << first.inputNames[j] << "=" << checker.cex[j];
+            cout << "\n Circuit 1 ->";
+            for (size_t k = 0; k < checker.outA.size(); k++) cout << " " << first.outputNames[k] << "=" << checker.outA[k];
+            cout << "\n Circuit 2 ->";
+            for (size_t k = 0; k < checker.outB.size(); k++)
+                cout << " " << second.outputNames[checker.outMap[k]] << "=" << checker.outB[k];
+            cout << "\n";
+        } else if (verdict == EquivalenceChecker::UNKNOWN) {
+            cout << " No difference found by simulation; SAT proof hit its conflict limit.\n";
+        }
+        cout << RESET;
+
+        record("EquivCheck", verdict == EquivalenceChecker::EQUIVALENT, "Equiv");
+    }
+};
+
+// ==========================================
+// SERVER MODE (JSON lines)
+// ==========================================
+
+// Appends code point cp to out as UTF-8
+void appendUtf8(string& out, unsigned long cp) {
+    if (cp < 0x80) out += (char)cp;
+    else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// Reads the 4 hex digits of a \uXXXX escape starting at pos
+bool hex4(const string& line, size_t pos, unsigned long& v) {
+    if (pos + 4 > line.length()) return false;
+    v = 0;
+    for (size_t i = pos; i < pos + 4; i++) {
+        if (!isxdigit((unsigned char)line[i])) return false;
+        v = v * 16 + (isdigit((unsigned char)line[i]) ? line[i] - '0' : (tolower(line[i]) - 'a' + 10));
+    }
+    return true;
+}
+
+// Decodes the JSON string whose opening quote is at pos
+bool jsonUnescape(const string& line, size_t pos, string& out) {
+    for (pos++; pos < line.length() && line[pos] != '"'; pos++) {
+        if (line[pos] != '\\') { out += line[pos]; continue; }
+        if (++pos >= line.length()) return false;
+        unsigned long cp, low;
+        switch (line[pos]) {
+            case '"': case '\\': case '/': out += line[pos]; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u':
+                if (!hex4(line, pos + 1, cp)) return false;
+                pos += 4;
+                if (cp >= 0xDC00 && cp <= 0xDFFF) return false;         // lone low surrogate
+                if (cp >= 0xD800 && cp <= 0xDBFF) {                     // needs its low half
+                    if (line.compare(pos + 1, 2, "\\u") != 0 || !hex4(line, pos + 3, low)) return false;
+                    if (low < 0xDC00 || low > 0xDFFF) return false;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    pos += 6;
+                }
+                appendUtf8(out, cp);
+                break;
+            default: return false;
+        }
+    }
+    return pos < line.length();
+}
+
+// Reads one field of a flat JSON object: {"op":"arith","a":5,...}.
+// Strings are unescaped; numbers and literals are returned as written.
+// A string that is not valid JSON returns false with isString set.
+bool jsonField(const string& line, const char* key, string& out, bool& isString) {
+    string pat = string("\"") + key + "\"";
+    size_t pos = 0;
+    isString = false;
+    for (;;) {                              // skip matches that are values, not keys
+        pos = line.find(pat, pos);
+        if (pos == string::npos) return false;
+        pos += pat.length();
+        while (pos < line.length() && isspace((unsigned char)line[pos])) pos++;
+        if (pos < line.length() && line[pos] == ':') break;
+    }
+    pos++;
+    while (pos < line.length() && isspace((unsigned char)line[pos])) pos++;
+
+    out.clear();
+    isString = pos < line.length() && line[pos] == '"';
+    if (isString) return jsonUnescape(line, pos, out);
+    while (pos < line.length() && line[pos] != ',' && line[pos] != '}') out += line[pos++];
+    while (!out.empty() && isspace((unsigned char)out[out.length() - 1])) out.erase(out.length() - 1);
+    return !out.empty();
+}
+
+string jsonString(const string& s) {
+    string r = "\"";
+    for (size_t i = 0; i < s.length(); i++) {
+        switch (s[i]) {
+            case '"': r += "\\\""; break;
+            case '\\': r += "\\\\"; break;
+            case '\b': r += "\\b"; break;
+            case '\f': r += "\\f"; break;
+            case '\n': r += "\\n"; break;
+            case '\r': r += "\\r"; break;
+            case '\t': r += "\\t"; break;
+            default:
+                if ((unsigned char)s[i] < 0x20) {      // other control characters
+                    char esc[8];
+                    sprintf(esc, "\\u%04x", (unsigned char)s[i]);
+                    r += esc;
+                } else {
+                    r += s[i];
+                }
+        }
+    }
+    return r + "\"";
+}
+
+string jsonNumber(double v) {
+    stringstream ss;
+    ss << setprecision(15) << v;
+    return ss.str();
+}
+
+// JSON number grammar: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isJsonNumber(const string& s) {
+    size_t i = 0, n = s.length();
+    if (i < n && s[i] == '-') i++;
+    if (i < n && s[i] == '0') i++;
+    else if (i < n && isdigit((unsigned char)s[i])) { while (i < n && isdigit((unsigned char)s[i])) i++; }
+    else return false;
+    if (i < n && s[i] == '.') {
+        if (++i >= n || !isdigit((unsigned char)s[i])) return false;
+        while (i < n && isdigit((unsigned char)s[i])) i++;
+    }
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        if (++i < n && (s[i] == '+' || s[i] == '-')) i++;
+        if (i >= n || !isdigit((unsigned char)s[i])) return false;
+        while (i < n && isdigit((unsigned char)s[i])) i++;
+    }
+    return i == n;
+}
+
+// inf - inf and nan - nan are both nan, so only finite values pass
+bool isFinite(double v) {
+    return v - v == 0;
+}
+
+// Serves requests against one warm Calculator. Each request is a JSON
+// object on its own line and gets exactly one JSON line back, in order:
+//   {"id":1,"op":"arith","a":5,"operator":"+","b":3}  -> {"id":1,"ok":true,"result":8}
+// Ops: arith, convert (value/from/to), set (name/value), get (name),
+// help (module), ping.
+class CalcServer {
+    Calculator& calc;
+
+    static bool number(const string& line, const char* key, double& v) {
+        string raw;
+        bool isString;
+        if (!jsonField(line, key, raw, isString) || isString || !isJsonNumber(raw)) return false;
+        v = strtod(raw.c_str(), NULL);
+        return isFinite(v);                 // 1e999 parses to inf
+    }
+
+    // A number that must be a whole int, e.g. a base; 2.5 or 1e300 is refused
+    static bool integer(const string& line, const char* key, int& v) {
+        double d;
+        if (!number(line, key, d) || d != floor(d) || d < INT_MIN || d > INT_MAX) return false;
+        v = (int)d;
+        return true;
+    }
+
+    // JSON has no inf or nan, so those results are reported as errors
+    static string result(double v) {
+        if (!isFinite(v)) return "\"ok\":false,\"error\":\"result is not finite\"";
+        return "\"ok\":true,\"result\":" + jsonNumber(v);
+    }
+
+    static bool text(const string& line, const char* key, string& v) {
+        bool isString;
+        return jsonField(line, key, v, isString) && isString;
+    }
+
+    string dispatch(const string& line) {
+        string op, s1, s2;
+        double a, b;
+        if (!text(line, "op", op)) return "\"ok\":false,\"error\":\"missing op\"";
+
+        if (op == "arith") {
+            if (!number(line, "a", a) || !number(line, "b", b) || !text(line, "operator", s1) || s1.length() != 1)
+                return "\"ok\":false,\"error\":\"arith needs a, b and operator\"";
+            if (string("+-*/").find(s1[0]) == string::npos) return "\"ok\":false,\"error\":\"unknown operator\"";
+            return result(calc.evalArithmetic(a, s1[0], b));
+        }
+        if (op == "convert") {
+            int from, to;
+            if (!text(line, "value", s1) || !integer(line, "from", from) || !integer(line, "to", to))
+                return "\"ok\":false,\"error\":\"convert needs value and integer from and to\"";
+            if (!calc.convertBase(s1, from, to, s2)) return "\"ok\":false,\"error\":\"invalid value or base\"";
+            return "\"ok\":true,\"result\":" + jsonString(s2);
+        }
+        if (op == "set") {
+            if (!text(line, "name", s1) || !number(line, "value", a))
+                return "\"ok\":false,\"error\":\"set needs name and value\"";
+            calc.storeVariable(s1, a);
+            return result(a);
+        }
+        if (op == "get") {
+            if (!text(line, "name", s1)) return "\"ok\":false,\"error\":\"get needs name\"";
+            if (!calc.lookupVariable(s1, a)) return "\"ok\":false,\"error\":\"variable not found\"";
+            return result(a);
+        }
+        if (op == "help") {
+            if (!text(line, "module", s1)) return "\"ok\":false,\"error\":\"help needs module\"";
+            return "\"ok\":true,\"result\":" + jsonString(calc.helpText(s1));
+        }
+        if (op == "ping") return "\"ok\":true,\"result\":\"pong\"";
+        return "\"ok\":false,\"error\":\"unknown op\"";
+    }
+
+public:
+    CalcServer(Calculator& c) : calc(c) {}
+
+    // The id is echoed back, so only a string or a plain number is taken
+    string handle(const string& line) {
+        string id;
+        bool isString;
+        if (!jsonField(line, "id", id, isString)) {
+            if (isString) return "{\"ok\":false,\"error\":\"id is not a valid JSON string\"}";
+            return "{" + dispatch(line) + "}";
+        }
+        if (!isString && (!isJsonNumber(id) || !isFinite(strtod(id.c_str(), NULL))))
+            return "{\"ok\":false,\"error\":\"id must be a number or string\"}";
+        return "{\"id\":" + (isString ? jsonString(id) : id) + "," + dispatch(line) + "}";
+    }
+
+    // Single client on stdin/stdout; output is flushed once the pending
+    // input is drained, so piped batches are answered in one write.
+    void serveStream(istream& in, ostream& out) {
+        string line;
+        while (getline(in, line)) {
+            if (!line.empty() && line[line.length() - 1] == '\r') line.erase(line.length() - 1);
+            if (!line.empty()) out << handle(line) << '\n';
+            if (in.rdbuf()->in_avail() <= 0) out.flush();
+        }
+        out.flush();
+    }
+
+#ifndef _WIN32
+private:
+    // One client socket, owned by the poll loop. While `busy` a worker is
+    // answering a batch; replies are queued in `outbox` and written by the
+    // loop, so no worker ever blocks on a socket.
+    struct Connection {
+        int fd;
+        string pending;             // received bytes not yet handed out
+        string batch;               // complete lines given to a worker
+        string outbox;              // replies waiting to be written
+        bool busy;
+        bool eof;
+        Connection(int fd) : fd(fd), busy(false), eof(false) {}
+    };
+
+    // Per-connection limits. Past MAX_BUFFERED of unread input or unsent
+    // replies the loop stops reading from that client until it catches up;
+    // a single line longer than MAX_LINE gets the client dropped.
+    static const size_t MAX_BUFFERED = 8 << 20;
+    static const size_t MAX_LINE = 1 << 20;
+
+    pthread_mutex_t queueLock;      // guards jobs, Connection::busy/outbox
+    pthread_cond_t queueReady;
+    deque<Connection*> jobs;
+    int wakeFds[2];                 // workers -> poll loop: replies are ready
+
+    void serveBatch(Connection* c) {
+        string out;
+        size_t start = 0, nl;
+        while ((nl = c->batch.find('\n', start)) != string::npos) {
+            size_t len = nl - start;
+            if (len > 0 && c->batch[nl - 1] == '\r') len--;
+            if (len > 0) out += handle(c->batch.substr(start, len)) + '\n';
+            start = nl + 1;
+        }
+
+        pthread_mutex_lock(&queueLock);
+        c->outbox += out;
+        c->busy = false;
+        pthread_mutex_unlock(&queueLock);
+        char wake = 0;
+        while (write(wakeFds[1], &wake, 1) < 0 && errno == EINTR) {}
+    }
+
+    static void* workerMain(void* arg) {
+        CalcServer* self = (CalcServer*)arg;
+        for (;;) {
+            pthread_mutex_lock(&self->queueLock);
+            while (self->jobs.empty()) pthread_cond_wait(&self->queueReady, &self->queueLock);
+            Connection* c = self->jobs.front();
+            self->jobs.pop_front();
+            pthread_mutex_unlock(&self->queueLock);
+            self->serveBatch(c);
+        }
+        return NULL;
+    }
+
+    // Input keeps being read while replies are pending (up to MAX_BUFFERED),
+    // so a client may write a pipeline before it starts reading.
+    bool readClient(Connection* c) {
+        char chunk[65536];
+        ssize_t n = read(c->fd, chunk, sizeof(chunk));
+        if (n > 0) c->pending.append(chunk, n);
+        else if (n == 0) c->eof = true;
+        else if (errno != EINTR && errno != EAGAIN) return false;
+        return true;
+    }
+
+    // Writes as much of the outbox as the socket takes without blocking
+    bool flushClient(Connection* c) {
+        string out;
+        pthread_mutex_lock(&queueLock);
+        out.swap(c->outbox);
+        pthread_mutex_unlock(&queueLock);
+        if (out.empty()) return true;
+
+        ssize_t n = write(c->fd, out.data(), out.length());
+        if (n < 0 && errno != EINTR && errno != EAGAIN) return false;
+        if (n < (ssize_t)out.length()) {
+            pthread_mutex_lock(&queueLock);
+            c->outbox.insert(0, out, n < 0 ? 0 : n, string::npos);
+            pthread_mutex_unlock(&queueLock);
+        }
+        return true;
+    }
+
+    // Hands every complete line received so far to the pool as one job;
+    // the caller holds queueLock. After EOF a final line without '\n'
+    // counts too, as it does for getline in serveStream().
+    void enqueue(Connection* c) {
+        if (c->eof && !c->pending.empty() && c->pending[c->pending.length() - 1] != '\n') c->pending += '\n';
+        size_t last = c->pending.rfind('\n');
+        if (last == string::npos) return;
+        c->batch = c->pending.substr(0, last + 1);
+        c->pending.erase(0, last + 1);
+        c->busy = true;
+        jobs.push_back(c);
+        pthread_cond_signal(&queueReady);
+    }
+
+    static pollfd watchFd(int fd) {
+        pollfd p;
+        p.fd = fd;
+        p.events = POLLIN;
+        p.revents = 0;
+        return p;
+    }
+
+public:
+    // A single poll() loop owns every client socket and hands each batch of
+    // complete request lines to one of `workers` pooled threads. Idle
+    // clients hold no thread, and a connection has at most one batch in
+    // flight, so its replies stay in request order.
+    int run(const char* path, int workers) {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(addr.sun_path)) {
+            cerr << "Socket path too long: " << path << endl;
+            return 1;
+        }
+        strcpy(addr.sun_path, path);
+
+        // Only a stale socket from an earlier run may be replaced
+        struct stat st;
+        if (lstat(path, &st) == 0) {
+            if (!S_ISSOCK(st.st_mode)) {
+                cerr << "Refusing to start: " << path << " exists and is not a socket" << endl;
+                return 1;
+            }
+            unlink(path);
+        }
+
+        signal(SIGPIPE, SIG_IGN);
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0 || bind(listener, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listener, 128) < 0) {
+            perror("server");
+            return 1;
+        }
+
+        pthread_mutex_init(&queueLock, NULL);
+        pthread_cond_init(&queueReady, NULL);
+        if (pipe(wakeFds) < 0) { perror("pipe"); return 1; }
+        fcntl(wakeFds[0], F_SETFL, O_NONBLOCK);
+        fcntl(wakeFds[1], F_SETFL, O_NONBLOCK);
+        for (int i = 0; i < workers; i++) {
+            pthread_t t;
+            if (pthread_create(&t, NULL, workerMain, this) != 0) { perror("pthread_create"); return 1; }
+            pthread_detach(t);
+        }
+        cerr << "EE-CALC server listening on " << path << " (" << workers << " workers)" << endl;
+
+        vector<Connection*> conns, polled;
+        vector<pollfd> fds;
+        for (;;) {
+            fds.clear();
+            polled.clear();
+            fds.push_back(watchFd(listener));
+            fds.push_back(watchFd(wakeFds[0]));
+
+            vector<Connection*> alive;
+            for (size_t i = 0; i < conns.size(); i++) {
+                Connection* c = conns[i];
+                bool ok = flushClient(c);
+
+                pthread_mutex_lock(&queueLock);
+                bool canEnqueue = ok && !c->busy && c->outbox.length() < MAX_BUFFERED;
+                if (canEnqueue) enqueue(c);
+                bool wantWrite = !c->outbox.empty();
+                bool outFull = c->outbox.length() >= MAX_BUFFERED;
+                bool busy = c->busy;
+                pthread_mutex_unlock(&queueLock);
+
+                // enqueue() leaves only an unfinished line in pending
+                bool tooLong = canEnqueue && c->pending.length() > MAX_LINE;
+
+                // Drop a broken client, one that sent an oversized line, or
+                // one that hung up and got every reply
+                if (!busy && (!ok || tooLong || (c->eof && !wantWrite))) {
+                    close(c->fd);
+                    delete c;
+                    continue;
+                }
+                alive.push_back(c);
+                if (!ok || tooLong) continue;   // only the worker is left
+                pollfd p = watchFd(c->fd);
+                if (c->eof || outFull || c->pending.length() >= MAX_BUFFERED) p.events = 0;
+                if (wantWrite) p.events |= POLLOUT;
+                if (p.events == 0) continue;    // woken through the pipe instead
+                fds.push_back(p);
+                polled.push_back(c);
+            }
+            conns.swap(alive);
+
+            if (poll(&fds[0], fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                perror("poll");
+                break;
+            }
+            if (fds[1].revents) {
+                char drain[256];
+                while (read(wakeFds[0], drain, sizeof(drain)) > 0) {}
+            }
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(listener, NULL, NULL);
+                if (fd >= 0) {
+                    fcntl(fd, F_SETFL, O_NONBLOCK);
+                    conns.push_back(new Connection(fd));
+                }
+            }
+            for (size_t k = 0; k < polled.size(); k++) {
+                short ev = fds[k + 2].revents;
+                if ((ev & (POLLIN | POLLHUP | POLLERR)) && !readClient(polled[k])) polled[k]->eof = true;
+            }
+        }
+        close(listener);
+        return 1;
+    }
+#endif
 };
 
 // ==========================================
 // MAIN
 // ==========================================
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Server mode: EE-CALC --serve [socket path | -] [workers]
+    if (argc > 1 && string(argv[1]) == "--serve") {
+        Calculator calc;
+        CalcServer server(calc);
+        string path = argc > 2 ? argv[2] : "/tmp/eecalc.sock";
+#ifndef _WIN32
+        if (path != "-") return server.run(path.c_str(), argc > 3 ? max(1, atoi(argv[3])) : 8);
+#endif
+        server.serveStream(cin, cout);
+        return 0;
+    }
+
     // ----------------------------------------------------
     // ASCII ART HEADER (With Colors)
     // ----------------------------------------------------
@@ -723,6 +2788,9 @@ int main() {
         cout << RED << "6. Circuit Model (Dynamic + Custom Truth Table)\n" << RESET;
         cout << WHITE << "7. Sort History (Bubble/Merge/Heap/Insert)\n" << RESET;
         cout << YELLOW << "8. Module Help (Hashing)\n" << RESET;
+        cout << YELLOW << "9. Bulk File Conversion (Streaming)\n" << RESET;
+        cout << RED << "10. Import Netlist (BLIF/Verilog)\n" << RESET;
+        cout << GREEN << "11. Equivalence Check (Two Circuits)\n" << RESET;
         cout << "0. Exit\n";
         cout << "Select: ";
         cin >> choice;
@@ -736,6 +2804,9 @@ int main() {
             case 6: calc.showCircuit(); break;
             case 7: calc.sortHistory(); break;
             case 8: calc.help(); break;
+            case 9: calc.bulkConversion(); break;
+            case 10: calc.importNetlist(); break;
+            case 11: calc.equivalenceCheck(); break;
             case 0: cout << "Exiting...\n"; break;
             default: cout << "Invalid choice!\n";
         }